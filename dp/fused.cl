@@ -0,0 +1,185 @@
+inline int ClampToCanvas(const int offset, const int range)
+{
+	return clamp(offset, (int)0, range - 1);
+}
+
+inline CLQuantum ClampToQuantum(const float value) { return (CLQuantum)(clamp(value, 0.0f, QuantumRange) + 0.5f); }
+
+inline unsigned int getPixelIndex(const unsigned int number_channels, const unsigned int columns, const unsigned int x, const unsigned int y) { return (x * number_channels) + (y * columns * number_channels); }
+
+inline float getPixelRed(const __global CLQuantum *p) { return (float)*p; }
+inline float getPixelGreen(const __global CLQuantum *p) { return (float)*(p + 1); }
+inline float getPixelBlue(const __global CLQuantum *p) { return (float)*(p + 2); }
+inline float getPixelAlpha(const __global CLQuantum *p, const unsigned int number_channels) { return (float)*(p + number_channels - 1); }
+inline void setPixelRed(__global CLQuantum *p, const CLQuantum value) { *p = value; }
+inline void setPixelGreen(__global CLQuantum *p, const CLQuantum value) { *(p + 1) = value; }
+inline void setPixelBlue(__global CLQuantum *p, const CLQuantum value) { *(p + 2) = value; }
+inline void setPixelAlpha(__global CLQuantum *p, const unsigned int number_channels, const CLQuantum value) { *(p + number_channels - 1) = value; }
+
+typedef enum {
+	UndefinedChannel = 0x0000,
+	RedChannel = 0x0001,
+	GrayChannel = 0x0001,
+	CyanChannel = 0x0001,
+	GreenChannel = 0x0002,
+	MagentaChannel = 0x0002,
+	BlueChannel = 0x0004,
+	YellowChannel = 0x0004,
+	BlackChannel = 0x0008,
+	AlphaChannel = 0x0010,
+	OpacityChannel = 0x0010,
+	IndexChannel = 0x0020,
+	ReadMaskChannel = 0x0040,
+	WriteMaskChannel = 0x0080,
+	MetaChannel = 0x0100,
+	CompositeChannels = 0x001F,
+	AllChannels = 0x7ffffff,
+	TrueAlphaChannel = 0x0100,
+	RGBChannels = 0x0200,
+	GrayChannels = 0x0400,
+	SyncChannels = 0x20000,
+	DefaultChannels = AllChannels
+} ChannelType;
+
+// Specialized builds define KERNEL_WIDTH, NUMBER_CHANNELS and CHANNEL_MASK, and
+// FILTER_TAPS when the coefficients are baked in too; the matching kernel
+// arguments are ignored then. FILTER_SYMMETRIC folds w[i] and w[width - 1 - i].
+#ifdef KERNEL_WIDTH
+#define Taps(width) KERNEL_WIDTH
+#else
+#define Taps(width) (width)
+#endif
+#ifdef NUMBER_CHANNELS
+#define Channels(number_channels) NUMBER_CHANNELS
+#define Mask(channel) ((ChannelType)CHANNEL_MASK)
+#else
+#define Channels(number_channels) (number_channels)
+#define Mask(channel) (channel)
+#endif
+#ifdef FILTER_TAPS
+__constant float filterTaps[] = { FILTER_TAPS };
+#define Tap(filter, i) filterTaps[i]
+#else
+#define Tap(filter, i) (filter)[i]
+#endif
+
+inline void WriteChannels(__global CLQuantum *p, const unsigned int number_channels, const ChannelType channel, float red, float green, float blue, float alpha)
+{
+	if ((channel & RedChannel) != 0)
+		setPixelRed(p, ClampToQuantum(red));
+	if (number_channels > 2)
+	{
+		if ((channel & GreenChannel) != 0)
+			setPixelGreen(p, ClampToQuantum(green));
+		if ((channel & BlueChannel) != 0)
+			setPixelBlue(p, ClampToQuantum(blue));
+	}
+	if (((number_channels == 4) || (number_channels == 2)) && ((channel & AlphaChannel) != 0))
+		setPixelAlpha(p, number_channels, ClampToQuantum(alpha));
+}
+
+inline void WriteFloat4(__global CLQuantum *image, const unsigned int number_channels, const unsigned int columns, const unsigned int x, const unsigned int y, const ChannelType channel, float4 pixel)
+{
+	__global CLQuantum *p = image + getPixelIndex(number_channels, columns, x, y);
+	WriteChannels(p, number_channels, channel, pixel.x, pixel.y, pixel.z, pixel.w);
+}
+
+inline void ReadChannels(const __global CLQuantum *p, const unsigned int number_channels, const ChannelType channel, float *red, float *green, float *blue, float *alpha)
+{
+	if ((channel & RedChannel) != 0)
+		*red = getPixelRed(p);
+	if (number_channels > 2)
+	{
+		if ((channel & GreenChannel) != 0)
+			*green = getPixelGreen(p);
+		if ((channel & BlueChannel) != 0)
+			*blue = getPixelBlue(p);
+	}
+	if (((number_channels == 4) || (number_channels == 2)) && ((channel & AlphaChannel) != 0))
+		*alpha = getPixelAlpha(p, number_channels);
+}
+
+inline float4 ReadFloat4(const __global CLQuantum *image, const unsigned int number_channels, const unsigned int columns, const unsigned int x, const unsigned int y, const ChannelType channel)
+{
+	const __global CLQuantum *p = image + getPixelIndex(number_channels, columns, x, y);
+	float red = 0.0f;
+	float green = 0.0f;
+	float blue = 0.0f;
+	float alpha = 0.0f;
+	ReadChannels(p, number_channels, channel, &red, &green, &blue, &alpha);
+	return (float4)(red, green, blue, alpha);
+}
+
+// One work group blurs a get_local_size(0) x get_local_size(1) tile. The
+// tile and its halo are read into local memory once, the row pass runs in
+// place there and the column pass reads its results from there, so only the
+// final pixels go back to global memory and there is no intermediate image.
+__kernel void Blur(const __global CLQuantum *image, const unsigned int number_channels,
+	const ChannelType channel, __constant float *filter, const unsigned int width,
+	const unsigned int imageColumns, const unsigned int imageRows, __local float4 *tile,
+	__global CLQuantum *filteredImage)
+{
+	const int x = get_global_id(0);
+	const int y = get_global_id(1);
+	const int columns = imageColumns;
+	const int rows = imageRows;
+	const int taps = Taps(width);
+	const unsigned int channels = Channels(number_channels);
+	const ChannelType mask = Mask(channel);
+	const int radius = (taps - 1) / 2;
+	const int localX = get_local_id(0);
+	const int localY = get_local_id(1);
+	const int tileWidth = get_local_size(0);
+	const int tileHeight = get_local_size(1);
+	const int loadWidth = tileWidth + taps - 1;
+	const int loadHeight = tileHeight + taps - 1;
+	const int groupX = get_group_id(0) * tileWidth - radius;
+	const int groupY = get_group_id(1) * tileHeight - radius;
+
+	for (int i = localY; i < loadHeight; i += tileHeight)
+	{
+		const int cy = ClampToCanvas(groupY + i, rows);
+		for (int j = localX; j < loadWidth; j += tileWidth)
+			tile[i * loadWidth + j] = ReadFloat4(image, channels, columns, ClampToCanvas(groupX + j, columns), cy, mask);
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+
+	// row pass, tileHeight rows at a time; a row's result replaces its centre
+	// only after every work item is done reading that row
+	for (int first = 0; first < loadHeight; first += tileHeight)
+	{
+		const int row = first + localY;
+		float4 result = (float4)0;
+		if (row < loadHeight)
+		{
+			const __local float4 *p = tile + row * loadWidth + localX;
+#ifdef FILTER_SYMMETRIC
+			for (int i = 0; i < radius; i++)
+				result += Tap(filter, i) * (p[i] + p[taps - 1 - i]);
+			result += Tap(filter, radius) * p[radius];
+#else
+			for (int i = 0; i < taps; i++)
+				result += Tap(filter, i) * p[i];
+#endif
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+		if (row < loadHeight)
+			tile[row * loadWidth + radius + localX] = result;
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+
+	if (x < columns && y < rows)
+	{
+		const __local float4 *p = tile + localY * loadWidth + radius + localX;
+		float4 result = (float4)0;
+#ifdef FILTER_SYMMETRIC
+		for (int i = 0; i < radius; i++)
+			result += Tap(filter, i) * (p[i * loadWidth] + p[(taps - 1 - i) * loadWidth]);
+		result += Tap(filter, radius) * p[radius * loadWidth];
+#else
+		for (int i = 0; i < taps; i++)
+			result += Tap(filter, i) * p[i * loadWidth];
+#endif
+		WriteFloat4(filteredImage, channels, columns, x, y, mask, result);
+	}
+}
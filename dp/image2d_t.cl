@@ -1,3 +1,8 @@
+// float output keeps the old +0.5 on alpha; UNORM_INT8 output rounds in write_imagef
+#ifndef OUTPUT_BIAS
+#define OUTPUT_BIAS ((float4)(0, 0, 0, 0.5f))
+#endif
+
 constant sampler_t sampler = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_NEAREST;
 
 __kernel void BlurRow(read_only image2d_t image, write_only image2d_t output,
@@ -7,7 +12,7 @@ __kernel void BlurRow(read_only image2d_t image, write_only image2d_t output,
 	const int y = get_global_id(1);
 
 	const uint radius = (kernel_width - 1) / 2;
-	const int groupX = get_local_size(0) * get_group_id(0);
+	const int groupX = get_global_offset(0) + get_local_size(0) * get_group_id(0);
 	const uint offset = groupX - radius;
 	if (get_global_id(0) < image_width) {
 		float4 res = (float4)0;
@@ -34,8 +39,8 @@ __kernel void BlurColumn(read_only image2d_t image, write_only image2d_t output,
 	const int y = get_global_id(1);
 
 	const uint radius = (kernel_width - 1) / 2;
-	const int groupX = get_local_size(0)*get_group_id(0);
-	const int groupY = get_local_size(1)*get_group_id(1);
+	const int groupX = get_global_offset(0) + get_local_size(0)*get_group_id(0);
+	const int groupY = get_global_offset(1) + get_local_size(1)*get_group_id(1);
 
 	const uint offset = groupY - radius;
 
@@ -54,6 +59,6 @@ __kernel void BlurColumn(read_only image2d_t image, write_only image2d_t output,
 			res += filter[i] * read_imagef(image, sampler, (int2)(x, offset + i + get_local_id(1)));
 		}
 
-		write_imagef(output, (int2)(x, y), res + (float4)(0, 0, 0, 0.5f));
+		write_imagef(output, (int2)(x, y), res + OUTPUT_BIAS);
 	}
 }
\ No newline at end of file
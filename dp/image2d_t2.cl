@@ -41,6 +41,28 @@ typedef enum {
 	DefaultChannels = AllChannels
 } ChannelType;
 
+// Specialized builds define KERNEL_WIDTH, NUMBER_CHANNELS and CHANNEL_MASK, and
+// FILTER_TAPS when the coefficients are baked in too; the matching kernel
+// arguments are ignored then. FILTER_SYMMETRIC folds w[i] and w[width - 1 - i].
+#ifdef KERNEL_WIDTH
+#define Taps(width) KERNEL_WIDTH
+#else
+#define Taps(width) (width)
+#endif
+#ifdef NUMBER_CHANNELS
+#define Channels(number_channels) NUMBER_CHANNELS
+#define Mask(channel) ((ChannelType)CHANNEL_MASK)
+#else
+#define Channels(number_channels) (number_channels)
+#define Mask(channel) (channel)
+#endif
+#ifdef FILTER_TAPS
+__constant float filterTaps[] = { FILTER_TAPS };
+#define Tap(filter, i) filterTaps[i]
+#else
+#define Tap(filter, i) (filter)[i]
+#endif
+
 inline void WriteChannels(__global CLQuantum *p, const unsigned int number_channels, const ChannelType channel, float red, float green, float blue, float alpha)
 {
 	if ((channel & RedChannel) != 0)
@@ -98,36 +120,44 @@ __kernel void BlurRow(const __global CLQuantum *image, const unsigned int number
 	const int x = get_global_id(0);
 	const int y = get_global_id(1);
 	const int columns = imageColumns;
-	const unsigned int radius = (width - 1) / 2;
+	const unsigned int taps = Taps(width);
+	const unsigned int radius = (taps - 1) / 2;
 
-	const int groupX = get_local_size(0) * get_group_id(0);
+	const int groupX = get_global_offset(0) + get_local_size(0) * get_group_id(0);
 
 	const int wsize = get_local_size(0);
-	const unsigned int loadSize = wsize + width;
+	const unsigned int loadSize = wsize + taps;
 
 	for (int i = get_local_id(0); i < loadSize; i = i + get_local_size(0))
 	{
 		int cx = ClampToCanvas(i + groupX - radius, columns);
-		temp[i] = ReadFloat4(image, number_channels, columns, cx, y, channel);
+		temp[i] = ReadFloat4(image, Channels(number_channels), columns, cx, y, Mask(channel));
 	}
 	barrier(CLK_LOCAL_MEM_FENCE);
 
 	if (get_global_id(0) < columns)
 	{
+		const __local float4 *p = temp + get_local_id(0);
 		float4 result = (float4)0;
+#ifdef FILTER_SYMMETRIC
+		for (int i = 0; i < radius; i++)
+			result += Tap(filter, i) * (p[i] + p[taps - 1 - i]);
+		result += Tap(filter, radius) * p[radius];
+#else
 		int i = 0;
-		for (; i + 7 < width;)
+		for (; i + 7 < taps;)
 		{
 			for (int j = 0; j < 8; j++)
 			{
-				result += filter[i + j] * temp[i + j + get_local_id(0)];
+				result += Tap(filter, i + j) * p[i + j];
 			}
 			i += 8;
 		}
-		for (; i < width; i++)
+		for (; i < taps; i++)
 		{
-			result += filter[i] * temp[i + get_local_id(0)];
+			result += Tap(filter, i) * p[i];
 		}
+#endif
 
 		write_imagef(tempImage, (int2)(x, y), result);
 	}
@@ -139,27 +169,35 @@ __kernel void BlurColumn(read_only image2d_t image, __global CLQuantum * output,
 	const int x = get_global_id(0);
 	const int y = get_global_id(1);
 
-	const uint radius = (kernel_width - 1) / 2;
-	const int groupX = get_local_size(0)*get_group_id(0);
-	const int groupY = get_local_size(1)*get_group_id(1);
+	const uint taps = Taps(kernel_width);
+	const uint radius = (taps - 1) / 2;
+	const int groupX = get_global_offset(0) + get_local_size(0)*get_group_id(0);
+	const int groupY = get_global_offset(1) + get_local_size(1)*get_group_id(1);
 
-	const uint offset = groupY - radius;
+	const int top = groupY - (int)radius + get_local_id(1);
 
 	if (get_global_id(1) < image_height) {
 		float4 res = (float4) 0;
 
+#ifdef FILTER_SYMMETRIC
+		for (int i = 0; i < radius; ++i) {
+			res += Tap(filter, i) * (read_imagef(image, sampler, (int2)(x, top + i)) + read_imagef(image, sampler, (int2)(x, top + taps - 1 - i)));
+		}
+		res += Tap(filter, radius) * read_imagef(image, sampler, (int2)(x, top + radius));
+#else
 		int i = 0;
 
-		for (; i + 7 < kernel_width; i += 8) {
+		for (; i + 7 < taps; i += 8) {
 			for (int j = 0; j < 8; ++j) {
-				res += filter[i + j] * read_imagef(image, sampler, (int2)(x, offset + i + j + get_local_id(1)));
+				res += Tap(filter, i + j) * read_imagef(image, sampler, (int2)(x, top + i + j));
 			}
 		}
 
-		for (; i < kernel_width; ++i) {
-			res += filter[i] * read_imagef(image, sampler, (int2)(x, offset + i + get_local_id(1)));
+		for (; i < taps; ++i) {
+			res += Tap(filter, i) * read_imagef(image, sampler, (int2)(x, top + i));
 		}
+#endif
 
-		WriteFloat4(output, number_channels, image_width, x, y, channel, res);
+		WriteFloat4(output, Channels(number_channels), image_width, x, y, Mask(channel), res);
 	}
 }
\ No newline at end of file
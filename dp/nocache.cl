@@ -41,6 +41,28 @@ typedef enum {
 	DefaultChannels = AllChannels
 } ChannelType;
 
+// Specialized builds define KERNEL_WIDTH, NUMBER_CHANNELS and CHANNEL_MASK, and
+// FILTER_TAPS when the coefficients are baked in too; the matching kernel
+// arguments are ignored then. FILTER_SYMMETRIC folds w[i] and w[width - 1 - i].
+#ifdef KERNEL_WIDTH
+#define Taps(width) KERNEL_WIDTH
+#else
+#define Taps(width) (width)
+#endif
+#ifdef NUMBER_CHANNELS
+#define Channels(number_channels) NUMBER_CHANNELS
+#define Mask(channel) ((ChannelType)CHANNEL_MASK)
+#else
+#define Channels(number_channels) (number_channels)
+#define Mask(channel) (channel)
+#endif
+#ifdef FILTER_TAPS
+__constant float filterTaps[] = { FILTER_TAPS };
+#define Tap(filter, i) filterTaps[i]
+#else
+#define Tap(filter, i) (filter)[i]
+#endif
+
 inline void WriteChannels(__global CLQuantum *p, const unsigned int number_channels, const ChannelType channel, float red, float green, float blue, float alpha)
 {
 	if ((channel & RedChannel) != 0)
@@ -94,24 +116,32 @@ __kernel void BlurRow(const __global CLQuantum *image, const unsigned int number
 	const int x = get_global_id(0);
 	const int y = get_global_id(1);
 	const int columns = imageColumns;
-	const unsigned int radius = (width - 1) / 2;
-	const int wsize = get_local_size(0);
-	const unsigned int loadSize = wsize + width;
-	const int groupX = get_local_size(0) * get_group_id(0);
+	const unsigned int taps = Taps(width);
+	const unsigned int channels = Channels(number_channels);
+	const ChannelType mask = Mask(channel);
+	const unsigned int radius = (taps - 1) / 2;
+	const int groupX = get_global_offset(0) + get_local_size(0) * get_group_id(0);
 	const int offset = groupX - radius + get_local_id(0);
 	
 	if (get_global_id(0) < columns)
 	{
 		float4 result = (float4)0;
+#ifdef FILTER_SYMMETRIC
+		for (int i = 0; i < radius; i++)
+			result += Tap(filter, i) * (ReadFloat4(image, channels, columns, ClampToCanvas(i + offset, columns), y, mask)
+				+ ReadFloat4(image, channels, columns, ClampToCanvas(taps - 1 - i + offset, columns), y, mask));
+		result += Tap(filter, radius) * ReadFloat4(image, channels, columns, ClampToCanvas(radius + offset, columns), y, mask);
+#else
 		int i = 0;
-		for (; i + 7 < width;)
+		for (; i + 7 < taps;)
 		{
 			for (int j = 0; j < 8; j++)
-				result += filter[i + j] * ReadFloat4(image, number_channels, columns, ClampToCanvas(i + j + offset, columns), y, channel);
+				result += Tap(filter, i + j) * ReadFloat4(image, channels, columns, ClampToCanvas(i + j + offset, columns), y, mask);
 			i += 8;
 		}
-		for (; i < width; i++)
-			result += filter[i] * ReadFloat4(image, number_channels, columns, ClampToCanvas(i + offset, columns), y, channel);
+		for (; i < taps; i++)
+			result += Tap(filter, i) * ReadFloat4(image, channels, columns, ClampToCanvas(i + offset, columns), y, mask);
+#endif
 		tempImage[y * columns + x] = result;
 	}
 }
@@ -124,24 +154,30 @@ __kernel void BlurColumn(const __global float4 *blurRowData, const unsigned int
 	const int y = get_global_id(1);
 	const int columns = imageColumns;
 	const int rows = imageRows;
-	unsigned int radius = (width - 1) / 2;
-	const int wsize = get_local_size(1);
-	const unsigned int loadSize = wsize + width;
-	const int groupX = get_local_size(0) * get_group_id(0);
-	const int groupY = get_local_size(1) * get_group_id(1);
+	const unsigned int taps = Taps(width);
+	unsigned int radius = (taps - 1) / 2;
+	const int groupX = get_global_offset(0) + get_local_size(0) * get_group_id(0);
+	const int groupY = get_global_offset(1) + get_local_size(1) * get_group_id(1);
 	const int offset = groupY - radius + get_local_id(1);
 	if (get_global_id(1) < rows)
 	{
 		float4 result = (float4)0;
+#ifdef FILTER_SYMMETRIC
+		for (int i = 0; i < radius; i++)
+			result += Tap(filter, i) * (blurRowData[ClampToCanvas(i + offset, rows) * columns + groupX]
+				+ blurRowData[ClampToCanvas(taps - 1 - i + offset, rows) * columns + groupX]);
+		result += Tap(filter, radius) * blurRowData[ClampToCanvas(radius + offset, rows) * columns + groupX];
+#else
 		int i = 0;
-		for (; i + 7 < width;)
+		for (; i + 7 < taps;)
 		{
 			for (int j = 0; j < 8; j++)
-				result += filter[i + j] * blurRowData[ClampToCanvas(i + j + offset, rows) * columns + groupX];
+				result += Tap(filter, i + j) * blurRowData[ClampToCanvas(i + j + offset, rows) * columns + groupX];
 			i += 8;
 		}
-		for (; i < width; i++)
-			result += filter[i] * blurRowData[ClampToCanvas(i + offset, rows) * columns + groupX];;
-		WriteFloat4(filteredImage, number_channels, columns, x, y, channel, result);
+		for (; i < taps; i++)
+			result += Tap(filter, i) * blurRowData[ClampToCanvas(i + offset, rows) * columns + groupX];
+#endif
+		WriteFloat4(filteredImage, Channels(number_channels), columns, x, y, Mask(channel), result);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,197 @@
+inline int ClampToCanvas(const int offset, const int range)
+{
+	return clamp(offset, (int)0, range - 1);
+}
+
+inline CLQuantum ClampToQuantum(const float value) { return (CLQuantum)(clamp(value, 0.0f, QuantumRange) + 0.5f); }
+
+inline unsigned int getPixelIndex(const unsigned int number_channels, const unsigned int columns, const unsigned int x, const unsigned int y) { return (x * number_channels) + (y * columns * number_channels); }
+
+inline float getPixelRed(const __global CLQuantum *p) { return (float)*p; }
+inline float getPixelGreen(const __global CLQuantum *p) { return (float)*(p + 1); }
+inline float getPixelBlue(const __global CLQuantum *p) { return (float)*(p + 2); }
+inline float getPixelAlpha(const __global CLQuantum *p, const unsigned int number_channels) { return (float)*(p + number_channels - 1); }
+inline void setPixelRed(__global CLQuantum *p, const CLQuantum value) { *p = value; }
+inline void setPixelGreen(__global CLQuantum *p, const CLQuantum value) { *(p + 1) = value; }
+inline void setPixelBlue(__global CLQuantum *p, const CLQuantum value) { *(p + 2) = value; }
+inline void setPixelAlpha(__global CLQuantum *p, const unsigned int number_channels, const CLQuantum value) { *(p + number_channels - 1) = value; }
+
+typedef enum {
+	UndefinedChannel = 0x0000,
+	RedChannel = 0x0001,
+	GrayChannel = 0x0001,
+	CyanChannel = 0x0001,
+	GreenChannel = 0x0002,
+	MagentaChannel = 0x0002,
+	BlueChannel = 0x0004,
+	YellowChannel = 0x0004,
+	BlackChannel = 0x0008,
+	AlphaChannel = 0x0010,
+	OpacityChannel = 0x0010,
+	IndexChannel = 0x0020,
+	ReadMaskChannel = 0x0040,
+	WriteMaskChannel = 0x0080,
+	MetaChannel = 0x0100,
+	CompositeChannels = 0x001F,
+	AllChannels = 0x7ffffff,
+	TrueAlphaChannel = 0x0100,
+	RGBChannels = 0x0200,
+	GrayChannels = 0x0400,
+	SyncChannels = 0x20000,
+	DefaultChannels = AllChannels
+} ChannelType;
+
+inline void WriteChannels(__global CLQuantum *p, const unsigned int number_channels, const ChannelType channel, float red, float green, float blue, float alpha)
+{
+	if ((channel & RedChannel) != 0)
+		setPixelRed(p, ClampToQuantum(red));
+	if (number_channels > 2)
+	{
+		if ((channel & GreenChannel) != 0)
+			setPixelGreen(p, ClampToQuantum(green));
+		if ((channel & BlueChannel) != 0)
+			setPixelBlue(p, ClampToQuantum(blue));
+	}
+	if (((number_channels == 4) || (number_channels == 2)) && ((channel & AlphaChannel) != 0))
+		setPixelAlpha(p, number_channels, ClampToQuantum(alpha));
+}
+
+inline void WriteFloat4(__global CLQuantum *image, const unsigned int number_channels, const unsigned int columns, const unsigned int x, const unsigned int y, const ChannelType channel, float4 pixel)
+{
+	__global CLQuantum *p = image + getPixelIndex(number_channels, columns, x, y);
+	WriteChannels(p, number_channels, channel, pixel.x, pixel.y, pixel.z, pixel.w);
+}
+
+inline void ReadChannels(const __global CLQuantum *p, const unsigned int number_channels, const ChannelType channel, float *red, float *green, float *blue, float *alpha)
+{
+	if ((channel & RedChannel) != 0)
+		*red = getPixelRed(p);
+	if (number_channels > 2)
+	{
+		if ((channel & GreenChannel) != 0)
+			*green = getPixelGreen(p);
+		if ((channel & BlueChannel) != 0)
+			*blue = getPixelBlue(p);
+	}
+	if (((number_channels == 4) || (number_channels == 2)) && ((channel & AlphaChannel) != 0))
+		*alpha = getPixelAlpha(p, number_channels);
+}
+
+inline float4 ReadFloat4(const __global CLQuantum *image, const unsigned int number_channels, const unsigned int columns, const unsigned int x, const unsigned int y, const ChannelType channel)
+{
+	const __global CLQuantum *p = image + getPixelIndex(number_channels, columns, x, y);
+	float red = 0.0f;
+	float green = 0.0f;
+	float blue = 0.0f;
+	float alpha = 0.0f;
+	ReadChannels(p, number_channels, channel, &red, &green, &blue, &alpha);
+	return (float4)(red, green, blue, alpha);
+}
+
+// Young-van Vliet recursive Gaussian, see GenerateRecursiveGaussian:
+// coefficients holds b, a1, a2, a3 and the 3x3 Triggs-Sdika matrix.
+// The recursion needs double precision for large sigma where available.
+#ifdef cl_khr_fp64
+#pragma OPENCL EXTENSION cl_khr_fp64 : enable
+typedef double real;
+typedef double4 real4;
+#define convert_real4 convert_double4
+#else
+typedef float real;
+typedef float4 real4;
+#define convert_real4 convert_float4
+#endif
+
+inline real4 Recurse(__constant float *c, const real4 x, const real4 w1, const real4 w2, const real4 w3)
+{
+	return (real)c[0] * x + (real)c[1] * w1 + (real)c[2] * w2 + (real)c[3] * w3;
+}
+
+// y[count - 1 + i] of a line that goes on with its last value
+inline real4 TriggsStart(__constant float *c, const int i, const real4 last, const real4 w1, const real4 w2, const real4 w3)
+{
+	return last + (real)c[4 + 3 * i] * (w1 - last) + (real)c[5 + 3 * i] * (w2 - last) + (real)c[6 + 3 * i] * (w3 - last);
+}
+
+// One work item per row; width is unused and only keeps the nocache argument order.
+__kernel void BlurRow(const __global CLQuantum *image, const unsigned int number_channels, const ChannelType channel, __constant float *coefficients,
+	const unsigned int width, const unsigned int imageColumns, const unsigned int imageRows, __global float4 *tempImage)
+{
+	const int y = get_global_id(0);
+	const int columns = imageColumns;
+	if (y >= imageRows)
+		return;
+
+	__global float4 *line = tempImage + y * columns;
+	const real4 last = convert_real4(ReadFloat4(image, number_channels, columns, columns - 1, y, channel));
+	real4 w1 = convert_real4(ReadFloat4(image, number_channels, columns, 0, y, channel));
+	real4 w2 = w1;
+	real4 w3 = w1;
+	for (int x = 0; x < columns; x++)
+	{
+		const real4 v = Recurse(coefficients, convert_real4(ReadFloat4(image, number_channels, columns, x, y, channel)), w1, w2, w3);
+		line[x] = convert_float4(v);
+		w3 = w2;
+		w2 = w1;
+		w1 = v;
+	}
+
+	const real4 y1 = TriggsStart(coefficients, 0, last, w1, w2, w3);
+	const real4 y2 = TriggsStart(coefficients, 1, last, w1, w2, w3);
+	const real4 y3 = TriggsStart(coefficients, 2, last, w1, w2, w3);
+	w1 = y1;
+	w2 = y2;
+	w3 = y3;
+	line[columns - 1] = convert_float4(w1);
+	for (int x = columns - 2; x >= 0; x--)
+	{
+		const real4 v = Recurse(coefficients, convert_real4(line[x]), w1, w2, w3);
+		line[x] = convert_float4(v);
+		w3 = w2;
+		w2 = w1;
+		w1 = v;
+	}
+}
+
+// One work item per column, so neighbouring work items read neighbouring pixels.
+__kernel void BlurColumn(__global float4 *blurRowData, const unsigned int number_channels,
+	const ChannelType channel, __constant float *coefficients, const unsigned int width,
+	const unsigned int imageColumns, const unsigned int imageRows,
+	__global CLQuantum *filteredImage)
+{
+	const int x = get_global_id(0);
+	const int columns = imageColumns;
+	const int rows = imageRows;
+	if (x >= columns)
+		return;
+
+	__global float4 *line = blurRowData + x;
+	const real4 last = convert_real4(line[(rows - 1) * columns]);
+	real4 w1 = convert_real4(line[0]);
+	real4 w2 = w1;
+	real4 w3 = w1;
+	for (int y = 0; y < rows; y++)
+	{
+		const real4 v = Recurse(coefficients, convert_real4(line[y * columns]), w1, w2, w3);
+		line[y * columns] = convert_float4(v);
+		w3 = w2;
+		w2 = w1;
+		w1 = v;
+	}
+
+	const real4 y1 = TriggsStart(coefficients, 0, last, w1, w2, w3);
+	const real4 y2 = TriggsStart(coefficients, 1, last, w1, w2, w3);
+	const real4 y3 = TriggsStart(coefficients, 2, last, w1, w2, w3);
+	w1 = y1;
+	w2 = y2;
+	w3 = y3;
+	WriteFloat4(filteredImage, number_channels, columns, x, rows - 1, channel, convert_float4(w1));
+	for (int y = rows - 2; y >= 0; y--)
+	{
+		const real4 v = Recurse(coefficients, convert_real4(line[y * columns]), w1, w2, w3);
+		WriteFloat4(filteredImage, number_channels, columns, x, y, channel, convert_float4(v));
+		w3 = w2;
+		w2 = w1;
+		w1 = v;
+	}
+}
@@ -111,7 +111,7 @@ __kernel void BlurRow(const __global CLQuantum *image, const unsigned int number
 	const int columns = imageColumns;
 	const unsigned int radius = (width - 1) / 2;
 
-	const int groupX = get_local_size(0) * get_group_id(0);
+	const int groupX = get_global_offset(0) + get_local_size(0) * get_group_id(0);
 
 	const int wsize = get_local_size(0);
 	const unsigned int loadSize = wsize + width;
@@ -152,8 +152,8 @@ __kernel void BlurColumn(read_only image2d_t image, __global CLQuantum * output,
 	const int y = get_global_id(1);
 
 	const uint radius = (kernel_width - 1) / 2;
-	const int groupX = get_local_size(0)*get_group_id(0);
-	const int groupY = get_local_size(1)*get_group_id(1);
+	const int groupX = get_global_offset(0) + get_local_size(0)*get_group_id(0);
+	const int groupY = get_global_offset(1) + get_local_size(1)*get_group_id(1);
 
 	const uint offset = groupY - radius;
 